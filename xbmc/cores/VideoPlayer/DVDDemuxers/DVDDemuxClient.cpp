@@ -403,7 +403,8 @@ std::vector<CDemuxStream*> CDVDDemuxClient::GetStreams() const
 void CDVDDemuxClient::RequestStreams()
 {
   std::map<int, std::shared_ptr<CDemuxStream>> newStreamMap;
-  for (auto stream : m_IDemux->GetStreams())
+  m_IDemux->GetStreams(m_streamsBuffer);
+  for (CDemuxStream* stream : m_streamsBuffer)
     SetStreamProps(stream, newStreamMap, false);
   m_streams = newStreamMap;
 }
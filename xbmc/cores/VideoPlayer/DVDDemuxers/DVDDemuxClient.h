@@ -55,6 +55,9 @@ protected:
   std::shared_ptr<CDVDInputStream> m_pInput;
   std::shared_ptr<CDVDInputStream::IDemux> m_IDemux;
   std::map<int, std::shared_ptr<CDemuxStream>> m_streams;
+  // reused buffer for querying the input's streams, to avoid an allocation
+  // per stream-change event
+  std::vector<CDemuxStream*> m_streamsBuffer;
   int m_displayTime;
   double m_dtsAtDisplayTime;
   std::unique_ptr<DemuxPacket> m_packet;
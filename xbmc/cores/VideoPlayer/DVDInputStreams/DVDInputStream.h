@@ -141,6 +141,14 @@ public:
     virtual DemuxPacket* ReadDemux() = 0;
     virtual CDemuxStream* GetStream(int iStreamId) const = 0;
     virtual std::vector<CDemuxStream*> GetStreams() const = 0;
+    /*!
+     * Variant of GetStreams filling a caller-owned buffer, avoiding an
+     * allocation per call when the buffer's capacity is reused
+     */
+    virtual void GetStreams(std::vector<CDemuxStream*>& streams) const
+    {
+      streams = GetStreams();
+    }
     virtual void EnableStream(int iStreamId, bool enable) {}
     virtual bool OpenStream(int iStreamId) { return false; }
     virtual int GetNrOfStreams() const = 0;
@@ -10,130 +10,430 @@
 
 #include "ServiceBroker.h"
 #include "cores/VideoPlayer/DVDDemuxers/DVDDemux.h"
+#include "cores/VideoPlayer/DVDDemuxers/DVDDemuxUtils.h"
 #include "cores/VideoPlayer/Interface/DemuxPacket.h"
 #include "pvr/PVRManager.h"
 #include "pvr/addons/PVRClient.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/Thread.h"
+#include "utils/EndianSwap.h"
+#include "utils/RingBuffer.h"
 #include "utils/log.h"
 
-CInputStreamPVRBase::CInputStreamPVRBase(const CFileItem& fileitem)
-  : CDVDInputStream(DVDSTREAM_TYPE_PVRMANAGER, fileitem),
-    m_StreamProps(std::make_shared<PVR_STREAM_PROPERTIES>()),
-    m_client(CServiceBroker::GetPVRManager().GetClient(fileitem))
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <mutex>
+
+using namespace std::chrono_literals;
+
+namespace
 {
-  if (!m_client)
+// ring capacity of the read-ahead buffer, in chunks of the addon's block size
+constexpr unsigned int READ_AHEAD_CHUNKS = 4;
+// chunk size used when the addon does not suggest one
+constexpr int READ_AHEAD_DEFAULT_CHUNK_SIZE = 32 * 1024;
+// maximum number of demux packets buffered ahead of the consumer
+constexpr size_t DEMUX_PREFETCH_CAPACITY = 64;
+
+FFmpegExtraData MakeSubtitleExtraData(uint32_t info)
+{
+  // byte-swap each 16 bit half of iSubtitleInfo, expressed as a rotate
+  // plus a single big-endian 32 bit store instead of four byte stores
+  const uint32_t swapped = Endian_SwapBE32((info << 16) | (info >> 16));
+  FFmpegExtraData extraData(4);
+  std::memcpy(extraData.GetData(), &swapped, sizeof(swapped));
+  return extraData;
+}
+} // unnamed namespace
+
+/*!
+ * Background reader keeping a small ring buffer filled from the addon, so the
+ * demuxer no longer blocks on the addon for every read. All addon access is
+ * serialized via m_readLock - reads and seeks here, and any other
+ * recorded-stream call the player makes directly, via CAddonCallGuard; the
+ * ring buffer has its own lock so the consumer can drain it while a read is
+ * in flight.
+ */
+class CInputStreamPVRBase::CReadAhead : public CThread
+{
+public:
+  CReadAhead(std::function<int(uint8_t*, int)> readFunc,
+             std::function<int64_t(int64_t, int)> seekFunc,
+             int chunkSize)
+    : CThread("PVRReadAhead"),
+      m_readFunc(std::move(readFunc)),
+      m_seekFunc(std::move(seekFunc)),
+      m_chunkSize(chunkSize)
   {
-    CLog::LogF(LOGERROR, "Unable to obtain pvr addon instance for item '{}'", fileitem.GetPath());
+    m_chunk.resize(chunkSize);
+    m_buffer.Create(chunkSize * READ_AHEAD_CHUNKS);
+    Create();
   }
-}
 
-CInputStreamPVRBase::~CInputStreamPVRBase()
-{
-  m_streamMap.clear();
-}
+  ~CReadAhead() override { StopThread(true); }
 
-bool CInputStreamPVRBase::IsEOF()
-{
-  return m_eof;
-}
+  int Read(uint8_t* buf, int bufSize)
+  {
+    while (!m_bStop)
+    {
+      {
+        std::unique_lock lock(m_bufferLock);
+        const unsigned int avail = m_buffer.getMaxReadSize();
+        if (avail > 0)
+        {
+          const unsigned int count = std::min(static_cast<unsigned int>(bufSize), avail);
+          m_buffer.ReadData(reinterpret_cast<char*>(buf), count);
+          m_spaceEvent.Set();
+          return static_cast<int>(count);
+        }
+        if (m_endOfStream)
+          return m_lastResult;
+      }
+      m_dataEvent.Wait(20ms);
+    }
+    return -1;
+  }
 
-bool CInputStreamPVRBase::Open()
-{
-  if (!m_isOpen && CDVDInputStream::Open() && OpenPVRStream())
+  CCriticalSection& AddonLock() { return m_readLock; }
+
+  int64_t Seek(int64_t offset, int whence)
   {
-    m_isOpen = true;
-    m_eof = false;
-    m_StreamProps->iStreamCount = 0;
-    return true;
+    std::unique_lock readLock(m_readLock);
+    std::unique_lock bufferLock(m_bufferLock);
+
+    // the addon position is ahead of the consumer by the buffered amount
+    if (whence == SEEK_CUR)
+      offset -= m_buffer.getMaxReadSize();
+
+    const int64_t ret = m_seekFunc(offset, whence);
+    if (ret >= 0)
+    {
+      m_buffer.Clear();
+      m_endOfStream = false;
+      m_lastResult = 0;
+      m_spaceEvent.Set();
+    }
+    return ret;
   }
-  else
+
+protected:
+  void Process() override
   {
-    return false;
+    while (!m_bStop)
+    {
+      bool full;
+      {
+        std::unique_lock lock(m_bufferLock);
+        full = m_endOfStream ||
+               m_buffer.getMaxWriteSize() < static_cast<unsigned int>(m_chunkSize);
+      }
+      if (full)
+      {
+        m_spaceEvent.Wait(100ms);
+        continue;
+      }
+
+      std::unique_lock readLock(m_readLock);
+      if (m_bStop)
+        break;
+
+      const int ret = m_readFunc(m_chunk.data(), m_chunkSize);
+
+      std::unique_lock bufferLock(m_bufferLock);
+      if (ret > 0)
+        m_buffer.WriteData(reinterpret_cast<const char*>(m_chunk.data()), ret);
+      else
+      {
+        m_endOfStream = true;
+        m_lastResult = ret < -1 ? -1 : ret;
+      }
+      m_dataEvent.Set();
+    }
   }
-}
 
-void CInputStreamPVRBase::Close()
+private:
+  const std::function<int(uint8_t*, int)> m_readFunc;
+  const std::function<int64_t(int64_t, int)> m_seekFunc;
+  const int m_chunkSize;
+  std::vector<uint8_t> m_chunk;
+  CRingBuffer m_buffer;
+  CCriticalSection m_readLock;
+  CCriticalSection m_bufferLock;
+  CEvent m_dataEvent;
+  CEvent m_spaceEvent;
+  bool m_endOfStream{false};
+  int m_lastResult{0};
+};
+
+/*!
+ * Producer thread keeping a bounded queue of demux packets filled from the
+ * addon, so ReadDemux() does not block on the addon for every packet. All
+ * other addon calls are serialized with the producer's DemuxRead via
+ * m_clientLock - flush, seek, speed and buffering through the methods below,
+ * times/pause/capability queries through CAddonCallGuard - preserving the
+ * single-threaded addon access the player loop used to guarantee. A
+ * successful seek or flush drains the queued pre-seek packets so they are
+ * never delivered, and STREAMINFO/STREAMCHANGE packets carry the stream
+ * properties snapshot taken when they were demuxed, so the consumer applies
+ * the layout valid for the packets queued behind them.
+ */
+class CInputStreamPVRBase::CDemuxPrefetch : public CThread
 {
-  if (m_isOpen)
+public:
+  explicit CDemuxPrefetch(const std::shared_ptr<PVR::CPVRClient>& client)
+    : CThread("PVRDemuxRead"), m_client(client)
   {
-    ClosePVRStream();
-    CDVDInputStream::Close();
-    m_eof = true;
-    m_isOpen = false;
+    Create();
   }
-}
 
-int CInputStreamPVRBase::Read(uint8_t* buf, int buf_size)
-{
-  int ret = ReadPVRStream(buf, buf_size);
+  ~CDemuxPrefetch() override
+  {
+    Abort();
+    StopThread(true);
+    Drain();
+  }
 
-  // we currently don't support non completing reads
-  if (ret == 0)
-    m_eof = true;
-  else if (ret < -1)
-    ret = -1;
+  CCriticalSection& ClientLock() { return m_clientLock; }
 
-  return ret;
-}
+  DemuxPacket* Read(std::shared_ptr<PVR_STREAM_PROPERTIES>& props)
+  {
+    while (!m_bStop)
+    {
+      {
+        std::unique_lock lock(m_queueLock);
+        if (!m_queue.empty())
+        {
+          DemuxPacket* packet = m_queue.front().packet;
+          props = std::move(m_queue.front().props);
+          m_queue.pop_front();
+          m_spaceEvent.Set();
+          return packet;
+        }
+      }
+      // preserve the former blocking behaviour: give the producer a moment
+      // before reporting "no packet" to the caller
+      if (!m_dataEvent.Wait(10ms))
+        return nullptr;
+    }
+    return nullptr;
+  }
+
+  void Abort()
+  {
+    m_bStop = true;
+    m_client->DemuxAbort(); // unblock a DemuxRead in flight
+    m_dataEvent.Set();
+    m_spaceEvent.Set();
+  }
+
+  void Flush()
+  {
+    std::unique_lock clientLock(m_clientLock);
+    m_client->DemuxFlush();
+    Drain();
+  }
+
+  bool SeekTime(double timems, bool backwards, double* startpts)
+  {
+    std::unique_lock clientLock(m_clientLock);
+    const bool ret = m_client->SeekTime(timems, backwards, startpts) == PVR_ERROR_NO_ERROR;
+    if (ret)
+      Drain(); // the queued packets are from before the seek
+    return ret;
+  }
+
+  void SetSpeed(int speed)
+  {
+    std::unique_lock clientLock(m_clientLock);
+    m_client->SetSpeed(speed);
+  }
+
+  void FillBuffer(bool mode)
+  {
+    std::unique_lock clientLock(m_clientLock);
+    m_client->FillBuffer(mode);
+  }
+
+protected:
+  void Process() override
+  {
+    while (!m_bStop)
+    {
+      {
+        std::unique_lock lock(m_queueLock);
+        if (m_queue.size() >= DEMUX_PREFETCH_CAPACITY)
+        {
+          lock.unlock();
+          m_spaceEvent.Wait(100ms);
+          continue;
+        }
+      }
+
+      std::unique_lock clientLock(m_clientLock);
+      if (m_bStop)
+        break;
+
+      DemuxPacket* packet = nullptr;
+      m_client->DemuxRead(packet);
+      if (!packet)
+      {
+        // no data available right now, avoid a busy loop
+        clientLock.unlock();
+        CThread::Sleep(10ms);
+        continue;
+      }
+
+      std::shared_ptr<PVR_STREAM_PROPERTIES> props;
+      if (packet->iStreamId == DMX_SPECIALID_STREAMINFO ||
+          packet->iStreamId == DMX_SPECIALID_STREAMCHANGE)
+      {
+        // snapshot the layout while still holding m_clientLock: by the time
+        // the consumer pops this packet a later change may already have
+        // altered the addon-side properties, and the packets queued in
+        // between must be matched against the layout valid when they were
+        // demuxed
+        props = std::make_shared<PVR_STREAM_PROPERTIES>();
+        m_client->GetStreamProperties(props.get());
+      }
 
-int64_t CInputStreamPVRBase::Seek(int64_t offset, int whence)
+      std::unique_lock lock(m_queueLock);
+      m_queue.push_back({packet, std::move(props)});
+      m_dataEvent.Set();
+    }
+  }
+
+private:
+  struct Packet
+  {
+    DemuxPacket* packet{nullptr};
+    // layout snapshot taken at DemuxRead time for STREAMINFO/STREAMCHANGE
+    std::shared_ptr<PVR_STREAM_PROPERTIES> props;
+  };
+
+  void Drain()
+  {
+    std::unique_lock lock(m_queueLock);
+    for (const Packet& entry : m_queue)
+      CDVDDemuxUtils::FreeDemuxPacket(entry.packet);
+    m_queue.clear();
+    m_spaceEvent.Set();
+  }
+
+  const std::shared_ptr<PVR::CPVRClient> m_client;
+  CCriticalSection m_clientLock;
+  CCriticalSection m_queueLock;
+  std::deque<Packet> m_queue;
+  CEvent m_dataEvent;
+  CEvent m_spaceEvent;
+};
+
+CInputStreamPVRBase::CAddonCallGuard::CAddonCallGuard(const CInputStreamPVRBase& stream)
 {
-  if (whence == DVDSTREAM_SEEK_POSSIBLE)
-    return CanSeek() ? 1 : 0;
+  if (stream.m_readAhead)
+    m_lock = &stream.m_readAhead->AddonLock();
+  else if (stream.m_demuxPrefetch)
+    m_lock = &stream.m_demuxPrefetch->ClientLock();
 
-  int64_t ret = SeekPVRStream(offset, whence);
+  if (m_lock)
+    m_lock->lock();
+}
 
-  // if we succeed, we are not eof anymore
-  if (ret >= 0)
-    m_eof = false;
+CInputStreamPVRBase::CAddonCallGuard::~CAddonCallGuard()
+{
+  if (m_lock)
+    m_lock->unlock();
+}
 
-  return ret;
+CInputStreamPVRBase::CInputStreamPVRBase(const CFileItem& fileitem)
+  : CDVDInputStream(DVDSTREAM_TYPE_PVRMANAGER, fileitem),
+    m_StreamProps(std::make_shared<PVR_STREAM_PROPERTIES>()),
+    m_client(CServiceBroker::GetPVRManager().GetClient(fileitem))
+{
+  if (!m_client)
+  {
+    CLog::LogF(LOGERROR, "Unable to obtain pvr addon instance for item '{}'", fileitem.GetPath());
+  }
 }
 
-int64_t CInputStreamPVRBase::GetLength()
+CInputStreamPVRBase::~CInputStreamPVRBase()
 {
-  return GetPVRStreamLength();
+  m_streamMap.clear();
 }
 
-int CInputStreamPVRBase::GetBlockSize()
+bool CInputStreamPVRBase::IsEOF()
 {
-  int ret = -1;
+  return m_eof;
+}
 
-  if (m_client)
-    m_client->GetStreamReadChunkSize(ret);
+void CInputStreamPVRBase::OnStreamOpened()
+{
+  m_isOpen = true;
+  m_eof = false;
+  m_blockSize.reset();
+  m_StreamProps->iStreamCount = 0;
+}
 
-  return ret;
+void CInputStreamPVRBase::OnStreamClosed()
+{
+  m_eof = true;
+  m_isOpen = false;
+  m_blockSize.reset();
 }
 
-bool CInputStreamPVRBase::GetTimes(Times &times)
+void CInputStreamPVRBase::StartReadAhead(std::function<int(uint8_t*, int)> readFunc,
+                                         std::function<int64_t(int64_t, int)> seekFunc,
+                                         bool canSeek,
+                                         bool realtime)
 {
-  return GetPVRStreamTimes(times);
+  // only prefetch seekable, non-realtime streams (recordings); realtime
+  // streams are paced by the addon and must not be read ahead of the consumer
+  if (!canSeek || realtime)
+    return;
+
+  int chunkSize = GetBlockSize();
+  if (chunkSize <= 0)
+    chunkSize = READ_AHEAD_DEFAULT_CHUNK_SIZE;
+
+  m_readAhead = std::make_unique<CReadAhead>(std::move(readFunc), std::move(seekFunc), chunkSize);
 }
 
-CDVDInputStream::ENextStream CInputStreamPVRBase::NextStream()
+void CInputStreamPVRBase::StopReadAhead()
 {
-  return NextPVRStream();
+  m_readAhead.reset();
 }
 
-bool CInputStreamPVRBase::CanPause()
+int CInputStreamPVRBase::ReadAheadRead(uint8_t* buf, int bufSize)
 {
-  return CanPausePVRStream();
+  return m_readAhead->Read(buf, bufSize);
 }
 
-bool CInputStreamPVRBase::CanSeek()
+int64_t CInputStreamPVRBase::ReadAheadSeek(int64_t offset, int whence)
 {
-  return CanSeekPVRStream();
+  return m_readAhead->Seek(offset, whence);
 }
 
-void CInputStreamPVRBase::Pause(bool bPaused)
+void CInputStreamPVRBase::StopDemuxPrefetch()
 {
-  PausePVRStream(bPaused);
+  m_demuxPrefetch.reset();
 }
 
-bool CInputStreamPVRBase::IsRealtime()
+int CInputStreamPVRBase::GetBlockSize()
 {
-  return IsRealtimePVRStream();
+  if (!m_blockSize)
+  {
+    int ret = -1;
+
+    if (m_client)
+      m_client->GetStreamReadChunkSize(ret);
+
+    m_blockSize = ret;
+  }
+
+  return *m_blockSize;
 }
 
 bool CInputStreamPVRBase::OpenDemux()
@@ -142,6 +442,8 @@ bool CInputStreamPVRBase::OpenDemux()
   {
     m_client->GetStreamProperties(m_StreamProps.get());
     UpdateStreamMap();
+    m_demuxPrefetch.reset();
+    m_demuxPrefetch = std::make_unique<CDemuxPrefetch>(m_client);
     return true;
   }
   else
@@ -156,20 +458,27 @@ DemuxPacket* CInputStreamPVRBase::ReadDemux()
     return nullptr;
 
   DemuxPacket* pPacket = nullptr;
-  m_client->DemuxRead(pPacket);
+  std::shared_ptr<PVR_STREAM_PROPERTIES> props;
+  if (m_demuxPrefetch)
+    pPacket = m_demuxPrefetch->Read(props);
+  else
+    m_client->DemuxRead(pPacket);
   if (!pPacket)
   {
     return nullptr;
   }
-  else if (pPacket->iStreamId == DMX_SPECIALID_STREAMINFO)
+  else if (pPacket->iStreamId == DMX_SPECIALID_STREAMINFO ||
+           pPacket->iStreamId == DMX_SPECIALID_STREAMCHANGE)
   {
-    m_client->GetStreamProperties(m_StreamProps.get());
-    return pPacket;
-  }
-  else if (pPacket->iStreamId == DMX_SPECIALID_STREAMCHANGE)
-  {
-    m_client->GetStreamProperties(m_StreamProps.get());
-    UpdateStreamMap();
+    // the prefetcher snapshots the props at DemuxRead time, so the layout
+    // matches this packet even when a later change is already queued behind it
+    if (props)
+      m_StreamProps = std::move(props);
+    else
+      m_client->GetStreamProperties(m_StreamProps.get());
+
+    if (pPacket->iStreamId == DMX_SPECIALID_STREAMCHANGE)
+      UpdateStreamMap();
   }
 
   return pPacket;
@@ -177,8 +486,10 @@ DemuxPacket* CInputStreamPVRBase::ReadDemux()
 
 CDemuxStream* CInputStreamPVRBase::GetStream(int iStreamId) const
 {
-  const auto stream = m_streamMap.find(iStreamId);
-  if (stream != m_streamMap.end())
+  const auto stream = std::lower_bound(
+      m_streamMap.cbegin(), m_streamMap.cend(), iStreamId,
+      [](const auto& entry, int iPID) { return entry.first < iPID; });
+  if (stream != m_streamMap.cend() && stream->first == iStreamId)
     return stream->second.get();
   else
     return nullptr;
@@ -187,12 +498,16 @@ CDemuxStream* CInputStreamPVRBase::GetStream(int iStreamId) const
 std::vector<CDemuxStream*> CInputStreamPVRBase::GetStreams() const
 {
   std::vector<CDemuxStream*> streams;
+  GetStreams(streams);
+  return streams;
+}
 
+void CInputStreamPVRBase::GetStreams(std::vector<CDemuxStream*>& streams) const
+{
+  streams.clear();
   streams.reserve(m_streamMap.size());
   for (const auto& [_, st] : m_streamMap)
     streams.emplace_back(st.get());
-
-  return streams;
 }
 
 int CInputStreamPVRBase::GetNrOfStreams() const
@@ -202,19 +517,25 @@ int CInputStreamPVRBase::GetNrOfStreams() const
 
 void CInputStreamPVRBase::SetSpeed(int Speed)
 {
-  if (m_client)
+  if (m_demuxPrefetch)
+    m_demuxPrefetch->SetSpeed(Speed);
+  else if (m_client)
     m_client->SetSpeed(Speed);
 }
 
 void CInputStreamPVRBase::FillBuffer(bool mode)
 {
-  if (m_client)
+  if (m_demuxPrefetch)
+    m_demuxPrefetch->FillBuffer(mode);
+  else if (m_client)
     m_client->FillBuffer(mode);
 }
 
 bool CInputStreamPVRBase::SeekTime(double timems, bool backwards, double *startpts)
 {
-  if (m_client)
+  if (m_demuxPrefetch)
+    return m_demuxPrefetch->SeekTime(timems, backwards, startpts);
+  else if (m_client)
     return m_client->SeekTime(timems, backwards, startpts) == PVR_ERROR_NO_ERROR;
   else
     return false;
@@ -222,20 +543,26 @@ bool CInputStreamPVRBase::SeekTime(double timems, bool backwards, double *startp
 
 void CInputStreamPVRBase::AbortDemux()
 {
-  if (m_client)
+  if (m_demuxPrefetch)
+    m_demuxPrefetch->Abort();
+  else if (m_client)
     m_client->DemuxAbort();
 }
 
 void CInputStreamPVRBase::FlushDemux()
 {
-  if (m_client)
+  if (m_demuxPrefetch)
+    m_demuxPrefetch->Flush();
+  else if (m_client)
     m_client->DemuxFlush();
 }
 
 std::shared_ptr<CDemuxStream> CInputStreamPVRBase::GetStreamInternal(int iStreamId)
 {
-  const auto stream = m_streamMap.find(iStreamId);
-  if (stream != m_streamMap.end())
+  const auto stream = std::lower_bound(
+      m_streamMap.cbegin(), m_streamMap.cend(), iStreamId,
+      [](const auto& entry, int iPID) { return entry.first < iPID; });
+  if (stream != m_streamMap.cend() && stream->first == iStreamId)
     return stream->second;
   else
     return nullptr;
@@ -243,21 +570,96 @@ std::shared_ptr<CDemuxStream> CInputStreamPVRBase::GetStreamInternal(int iStream
 
 void CInputStreamPVRBase::UpdateStreamMap()
 {
-  std::map<int, std::shared_ptr<CDemuxStream>> newStreamMap;
-
   int num = GetNrOfStreams();
+
+  // look the setting up once instead of once per stream
+  const bool enableRadioRDS =
+      CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool("pvrplayback.enableradiords");
+
+  // FNV-1a fingerprint of the reported layout. PIDs, codecs and the RDS
+  // setting determine the shape of the map; everything else is a mutable
+  // field of an already existing stream object
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  const auto mix = [&hash](uint64_t value)
+  {
+    hash ^= value;
+    hash *= 0x100000001b3ULL;
+  };
+  mix(static_cast<uint64_t>(num));
+  mix(enableRadioRDS ? 1 : 0);
   for (int i = 0; i < num; ++i)
   {
-    PVR_STREAM_PROPERTIES::PVR_STREAM stream = m_StreamProps->stream[i];
+    const PVR_STREAM_PROPERTIES::PVR_STREAM& stream = m_StreamProps->stream[i];
+    mix(static_cast<uint32_t>(stream.iPID));
+    mix(static_cast<uint32_t>(stream.iCodecId));
+    mix(static_cast<uint32_t>(stream.iCodecType));
+  }
 
-    std::shared_ptr<CDemuxStream> dStream = GetStreamInternal(stream.iPID);
+  if (hash == m_streamLayoutHash && static_cast<size_t>(num) == m_streamMap.size())
+  {
+    // unchanged layout: refresh the mutable fields of the existing stream
+    // objects in place, with no allocation and no map rebuild
+    for (int i = 0; i < num; ++i)
+    {
+      const PVR_STREAM_PROPERTIES::PVR_STREAM& stream = m_StreamProps->stream[i];
+      const std::shared_ptr<CDemuxStream> dStream = GetStreamInternal(stream.iPID);
+      if (!dStream)
+        continue;
+
+      dStream->language = stream.strLanguage;
+
+      if (dStream->type == StreamType::AUDIO)
+      {
+        const auto streamAudio = std::static_pointer_cast<CDemuxStreamAudio>(dStream);
+        streamAudio->iChannels = stream.iChannels;
+        streamAudio->iSampleRate = stream.iSampleRate;
+        streamAudio->iBlockAlign = stream.iBlockAlign;
+        streamAudio->iBitRate = stream.iBitRate;
+        streamAudio->iBitsPerSample = stream.iBitsPerSample;
+      }
+      else if (dStream->type == StreamType::VIDEO)
+      {
+        const auto streamVideo = std::static_pointer_cast<CDemuxStreamVideo>(dStream);
+        streamVideo->iFpsScale = stream.iFPSScale;
+        streamVideo->iFpsRate = stream.iFPSRate;
+        streamVideo->iHeight = stream.iHeight;
+        streamVideo->iWidth = stream.iWidth;
+        streamVideo->fAspect = static_cast<double>(stream.fAspect);
+      }
+      else if (dStream->type == StreamType::SUBTITLE && stream.iSubtitleInfo)
+      {
+        std::static_pointer_cast<CDemuxStreamSubtitle>(dStream)->extraData =
+            MakeSubtitleExtraData(static_cast<uint32_t>(stream.iSubtitleInfo));
+      }
+    }
+    return;
+  }
+
+  m_streamLayoutHash = hash;
+
+  // entries still present in the reported layout; unmarked ones get erased below
+  std::vector<bool> seen(m_streamMap.size(), false);
+  std::vector<std::pair<int, std::shared_ptr<CDemuxStream>>> newStreams;
+
+  for (int i = 0; i < num; ++i)
+  {
+    const PVR_STREAM_PROPERTIES::PVR_STREAM& stream = m_StreamProps->stream[i];
+
+    const auto entry = std::lower_bound(
+        m_streamMap.begin(), m_streamMap.end(), stream.iPID,
+        [](const auto& e, int iPID) { return e.first < iPID; });
+    const bool existing = (entry != m_streamMap.end() && entry->first == stream.iPID);
+
+    std::shared_ptr<CDemuxStream> dStream;
+    if (existing)
+      dStream = entry->second;
 
     if (stream.iCodecType == PVR_CODEC_TYPE_AUDIO)
     {
       std::shared_ptr<CDemuxStreamAudio> streamAudio;
 
-      if (dStream)
-        streamAudio = std::dynamic_pointer_cast<CDemuxStreamAudio>(dStream);
+      if (dStream && dStream->type == StreamType::AUDIO)
+        streamAudio = std::static_pointer_cast<CDemuxStreamAudio>(dStream);
       if (!streamAudio)
         streamAudio = std::make_shared<CDemuxStreamAudio>();
 
@@ -273,8 +675,8 @@ void CInputStreamPVRBase::UpdateStreamMap()
     {
       std::shared_ptr<CDemuxStreamVideo> streamVideo;
 
-      if (dStream)
-        streamVideo = std::dynamic_pointer_cast<CDemuxStreamVideo>(dStream);
+      if (dStream && dStream->type == StreamType::VIDEO)
+        streamVideo = std::static_pointer_cast<CDemuxStreamVideo>(dStream);
       if (!streamVideo)
         streamVideo = std::make_shared<CDemuxStreamVideo>();
 
@@ -290,8 +692,8 @@ void CInputStreamPVRBase::UpdateStreamMap()
     {
       std::shared_ptr<CDemuxStreamTeletext> streamTeletext;
 
-      if (dStream)
-        streamTeletext = std::dynamic_pointer_cast<CDemuxStreamTeletext>(dStream);
+      if (dStream && dStream->type == StreamType::TELETEXT)
+        streamTeletext = std::static_pointer_cast<CDemuxStreamTeletext>(dStream);
       if (!streamTeletext)
         streamTeletext = std::make_shared<CDemuxStreamTeletext>();
 
@@ -301,29 +703,23 @@ void CInputStreamPVRBase::UpdateStreamMap()
     {
       std::shared_ptr<CDemuxStreamSubtitle> streamSubtitle;
 
-      if (dStream)
-        streamSubtitle = std::dynamic_pointer_cast<CDemuxStreamSubtitle>(dStream);
+      if (dStream && dStream->type == StreamType::SUBTITLE)
+        streamSubtitle = std::static_pointer_cast<CDemuxStreamSubtitle>(dStream);
       if (!streamSubtitle)
         streamSubtitle = std::make_shared<CDemuxStreamSubtitle>();
 
       if (stream.iSubtitleInfo)
-      {
-        streamSubtitle->extraData = FFmpegExtraData(4);
-        streamSubtitle->extraData.GetData()[0] = (stream.iSubtitleInfo >> 8) & 0xff;
-        streamSubtitle->extraData.GetData()[1] = (stream.iSubtitleInfo >> 0) & 0xff;
-        streamSubtitle->extraData.GetData()[2] = (stream.iSubtitleInfo >> 24) & 0xff;
-        streamSubtitle->extraData.GetData()[3] = (stream.iSubtitleInfo >> 16) & 0xff;
-      }
+        streamSubtitle->extraData =
+            MakeSubtitleExtraData(static_cast<uint32_t>(stream.iSubtitleInfo));
+
       dStream = streamSubtitle;
     }
-    else if (stream.iCodecType == PVR_CODEC_TYPE_RDS &&
-             CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(
-                 "pvrplayback.enableradiords"))
+    else if (stream.iCodecType == PVR_CODEC_TYPE_RDS && enableRadioRDS)
     {
       std::shared_ptr<CDemuxStreamRadioRDS> streamRadioRDS;
 
-      if (dStream)
-        streamRadioRDS = std::dynamic_pointer_cast<CDemuxStreamRadioRDS>(dStream);
+      if (dStream && dStream->type == StreamType::RADIO_RDS)
+        streamRadioRDS = std::static_pointer_cast<CDemuxStreamRadioRDS>(dStream);
       if (!streamRadioRDS)
         streamRadioRDS = std::make_shared<CDemuxStreamRadioRDS>();
 
@@ -333,22 +729,43 @@ void CInputStreamPVRBase::UpdateStreamMap()
     {
       std::shared_ptr<CDemuxStreamAudioID3> streamAudioID3;
 
-      if (dStream)
-        streamAudioID3 = std::dynamic_pointer_cast<CDemuxStreamAudioID3>(dStream);
+      if (dStream && dStream->type == StreamType::AUDIO_ID3)
+        streamAudioID3 = std::static_pointer_cast<CDemuxStreamAudioID3>(dStream);
       if (!streamAudioID3)
         streamAudioID3 = std::make_shared<CDemuxStreamAudioID3>();
 
       dStream = std::move(streamAudioID3);
     }
-    else
+    else if (!dStream || dStream->type != StreamType::NONE)
       dStream = std::make_shared<CDemuxStream>();
 
     dStream->codec = (AVCodecID)stream.iCodecId;
     dStream->uniqueId = stream.iPID;
     dStream->language = stream.strLanguage;
 
-    newStreamMap[stream.iPID] = dStream;
+    if (existing)
+    {
+      seen[std::distance(m_streamMap.begin(), entry)] = true;
+      // only replace the shared_ptr when the stream type changed; otherwise the
+      // existing object was updated in place above
+      if (entry->second != dStream)
+        entry->second = std::move(dStream);
+    }
+    else
+      newStreams.emplace_back(stream.iPID, std::move(dStream));
   }
 
-  m_streamMap = newStreamMap;
+  // drop entries for PIDs no longer reported by the addon
+  size_t idx = 0;
+  m_streamMap.erase(std::remove_if(m_streamMap.begin(), m_streamMap.end(),
+                                   [&seen, &idx](const auto&) { return !seen[idx++]; }),
+                    m_streamMap.end());
+
+  if (!newStreams.empty())
+  {
+    m_streamMap.insert(m_streamMap.end(), std::make_move_iterator(newStreams.begin()),
+                       std::make_move_iterator(newStreams.end()));
+    std::sort(m_streamMap.begin(), m_streamMap.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+  }
 }
@@ -10,10 +10,13 @@
 
 #include "DVDInputStream.h"
 
-#include <map>
+#include <functional>
 #include <memory>
+#include <optional>
+#include <utility>
 #include <vector>
 
+class CCriticalSection;
 class CFileItem;
 class IDemux;
 class IVideoPlayer;
@@ -32,23 +35,13 @@ class CInputStreamPVRBase
 public:
   explicit CInputStreamPVRBase(const CFileItem& fileitem);
   ~CInputStreamPVRBase() override;
-  bool Open() override;
-  void Close() override;
-  int Read(uint8_t* buf, int buf_size) override;
-  int64_t Seek(int64_t offset, int whence) override;
   bool IsEOF() override;
-  int64_t GetLength() override;
   int GetBlockSize() override;
 
-  ENextStream NextStream() override;
-  bool IsRealtime() override;
-
   CDVDInputStream::ITimes* GetITimes() override { return this; }
-  bool GetTimes(Times &times) override;
 
-  bool CanSeek() override; //! @todo drop this
-  bool CanPause() override;
-  void Pause(bool bPaused);
+  //! Pause the underlying stream, called by the player on speed changes
+  virtual void Pause(bool bPaused) = 0;
 
   // Demux interface
   CDVDInputStream::IDemux* GetIDemux() override { return nullptr; }
@@ -56,6 +49,7 @@ public:
   DemuxPacket* ReadDemux() override;
   CDemuxStream* GetStream(int iStreamId) const override;
   std::vector<CDemuxStream*> GetStreams() const override;
+  void GetStreams(std::vector<CDemuxStream*>& streams) const override;
   int GetNrOfStreams() const override;
   void SetSpeed(int iSpeed) override;
   void FillBuffer(bool mode) override;
@@ -64,28 +58,173 @@ public:
   void FlushDemux() override;
 
 protected:
+  /*!
+   * RAII guard serializing a direct addon call with the background worker
+   * (read-ahead or demux prefetch). The addon ABI does not promise thread
+   * safety, so calls the player makes from its own thread must not overlap
+   * a read the worker has in flight. No-op while no worker is running.
+   */
+  class CAddonCallGuard
+  {
+  public:
+    explicit CAddonCallGuard(const CInputStreamPVRBase& stream);
+    ~CAddonCallGuard();
+
+    CAddonCallGuard(const CAddonCallGuard&) = delete;
+    CAddonCallGuard& operator=(const CAddonCallGuard&) = delete;
+
+  private:
+    CCriticalSection* m_lock{nullptr};
+  };
+
   PVR::CPVRClient& GetClient() const { return *m_client; }
   bool IsEOF() const { return m_eof; }
 
   void UpdateStreamMap();
   std::shared_ptr<CDemuxStream> GetStreamInternal(int iStreamId);
 
-  virtual bool OpenPVRStream() = 0;
-  virtual void ClosePVRStream() = 0;
-  virtual int ReadPVRStream(uint8_t* buf, int buf_size) = 0;
-  virtual int64_t SeekPVRStream(int64_t offset, int whence) = 0;
-  virtual int64_t GetPVRStreamLength() = 0;
-  virtual ENextStream NextPVRStream() = 0;
-  virtual bool CanPausePVRStream() = 0;
-  virtual bool CanSeekPVRStream() = 0;
-  virtual bool IsRealtimePVRStream() = 0;
-  virtual void PausePVRStream(bool paused) = 0;
-  virtual bool GetPVRStreamTimes(Times& times) = 0;
+  void OnStreamOpened();
+  void OnStreamClosed();
+
+  void StartReadAhead(std::function<int(uint8_t*, int)> readFunc,
+                      std::function<int64_t(int64_t, int)> seekFunc,
+                      bool canSeek,
+                      bool realtime);
+  void StopReadAhead();
+  bool HasReadAhead() const { return m_readAhead != nullptr; }
+  int ReadAheadRead(uint8_t* buf, int bufSize);
+  int64_t ReadAheadSeek(int64_t offset, int whence);
+
+  void StopDemuxPrefetch();
 
-private:
   bool m_eof = true;
+  bool m_isOpen{false};
+
+private:
+  class CReadAhead;
+  class CDemuxPrefetch;
+
+  // the addon's read chunk size cannot change during a session, so the result
+  // of the first GetStreamReadChunkSize round-trip is kept until Close()
+  std::optional<int> m_blockSize;
   std::shared_ptr<PVR_STREAM_PROPERTIES> m_StreamProps;
-  std::map<int, std::shared_ptr<CDemuxStream>> m_streamMap;
+  // stream map entries, sorted by PID. stream counts are small, so a flat
+  // sorted vector beats a node-based map for both lookup and rebuild
+  std::vector<std::pair<int, std::shared_ptr<CDemuxStream>>> m_streamMap;
+  // fingerprint of the last reported stream layout (PIDs, codecs); while it is
+  // unchanged UpdateStreamMap only refreshes the mutable fields in place
+  uint64_t m_streamLayoutHash{0};
   std::shared_ptr<PVR::CPVRClient> m_client;
-  bool m_isOpen{false};
+  // background reader overlapping addon I/O with demuxing, only active for
+  // seekable non-realtime streams (recordings)
+  std::unique_ptr<CReadAhead> m_readAhead;
+  // producer thread pre-buffering addon demux packets for ReadDemux()
+  std::unique_ptr<CDemuxPrefetch> m_demuxPrefetch;
+};
+
+/*!
+ * CRTP layer implementing the player-facing entry points on top of the
+ * stream-type specific hooks of Derived. The hooks are plain member functions
+ * resolved at compile time, so the per-packet hot path (Read/Seek) does not
+ * pay a second virtual dispatch on top of CDVDInputStream's.
+ */
+template<class Derived>
+class CInputStreamPVRImpl : public CInputStreamPVRBase
+{
+public:
+  using CInputStreamPVRBase::CInputStreamPVRBase;
+
+  bool Open() override
+  {
+    if (!m_isOpen && CDVDInputStream::Open() && Self()->OpenPVRStream())
+    {
+      OnStreamOpened();
+      return true;
+    }
+    else
+    {
+      return false;
+    }
+  }
+
+  void Close() override
+  {
+    if (m_isOpen)
+    {
+      StopDemuxPrefetch();
+      StopReadAhead();
+      Self()->ClosePVRStream();
+      CDVDInputStream::Close();
+      OnStreamClosed();
+    }
+  }
+
+  int Read(uint8_t* buf, int buf_size) override
+  {
+    int ret = HasReadAhead() ? ReadAheadRead(buf, buf_size) : Self()->ReadPVRStream(buf, buf_size);
+
+    // we currently don't support non completing reads. branchless: the
+    // assignment is a setcc and the clamp a cmov, keeping the common
+    // ret > 0 case free of conditional branches
+    m_eof = (ret == 0);
+    ret = ret < -1 ? -1 : ret;
+
+    return ret;
+  }
+
+  int64_t Seek(int64_t offset, int whence) override
+  {
+    if (whence == DVDSTREAM_SEEK_POSSIBLE)
+      return Self()->CanSeekPVRStream() ? 1 : 0;
+
+    int64_t ret =
+        HasReadAhead() ? ReadAheadSeek(offset, whence) : Self()->SeekPVRStream(offset, whence);
+
+    // if we succeed, we are not eof anymore
+    if (ret >= 0)
+      m_eof = false;
+
+    return ret;
+  }
+
+  int64_t GetLength() override
+  {
+    const CAddonCallGuard guard(*this);
+    return Self()->GetPVRStreamLength();
+  }
+
+  ENextStream NextStream() override { return Self()->NextPVRStream(); }
+
+  bool CanPause() override
+  {
+    const CAddonCallGuard guard(*this);
+    return Self()->CanPausePVRStream();
+  }
+
+  bool CanSeek() override //! @todo drop this
+  {
+    const CAddonCallGuard guard(*this);
+    return Self()->CanSeekPVRStream();
+  }
+
+  bool IsRealtime() override
+  {
+    const CAddonCallGuard guard(*this);
+    return Self()->IsRealtimePVRStream();
+  }
+
+  void Pause(bool bPaused) override
+  {
+    const CAddonCallGuard guard(*this);
+    Self()->PausePVRStream(bPaused);
+  }
+
+  bool GetTimes(Times& times) override
+  {
+    const CAddonCallGuard guard(*this);
+    return Self()->GetPVRStreamTimes(times);
+  }
+
+private:
+  Derived* Self() { return static_cast<Derived*>(this); }
 };
@@ -10,26 +10,28 @@
 
 #include "InputStreamPVRBase.h"
 
-class CInputStreamPVRChannel : public CInputStreamPVRBase
+class CInputStreamPVRChannel : public CInputStreamPVRImpl<CInputStreamPVRChannel>
 {
 public:
-  using CInputStreamPVRBase::CInputStreamPVRBase;
+  using CInputStreamPVRImpl::CInputStreamPVRImpl;
   ~CInputStreamPVRChannel() override;
 
   CDVDInputStream::IDemux* GetIDemux() override;
 
 protected:
-  bool OpenPVRStream() override;
-  void ClosePVRStream() override;
-  int ReadPVRStream(uint8_t* buf, int buf_size) override;
-  int64_t SeekPVRStream(int64_t offset, int whence) override;
-  int64_t GetPVRStreamLength() override;
-  ENextStream NextPVRStream() override;
-  bool CanPausePVRStream() override;
-  bool CanSeekPVRStream() override;
-  bool IsRealtimePVRStream() override;
-  void PausePVRStream(bool paused) override;
-  bool GetPVRStreamTimes(Times& times) override;
+  friend class CInputStreamPVRImpl<CInputStreamPVRChannel>;
+
+  bool OpenPVRStream();
+  void ClosePVRStream();
+  int ReadPVRStream(uint8_t* buf, int buf_size);
+  int64_t SeekPVRStream(int64_t offset, int whence);
+  int64_t GetPVRStreamLength();
+  ENextStream NextPVRStream();
+  bool CanPausePVRStream();
+  bool CanSeekPVRStream();
+  bool IsRealtimePVRStream();
+  void PausePVRStream(bool paused);
+  bool GetPVRStreamTimes(Times& times);
 
 private:
   bool m_bDemuxActive = false;
@@ -33,6 +33,13 @@ bool CInputStreamPVRRecording::OpenPVRStream()
   if (recording && (GetClient().OpenRecordedStream(recording, m_streamId) == PVR_ERROR_NO_ERROR))
   {
     CLog::LogF(LOGDEBUG, "Opened recording stream {}", m_item.GetPath());
+
+    // recordings are plain byte streams read through ReadRecordedStream, so they
+    // are the only PVR streams safe to read ahead of the consumer; live channels
+    // may be consumed through the demux interface instead
+    StartReadAhead([this](uint8_t* buf, int buf_size) { return ReadPVRStream(buf, buf_size); },
+                   [this](int64_t offset, int whence) { return SeekPVRStream(offset, whence); },
+                   CanSeekPVRStream(), IsRealtimePVRStream());
     return true;
   }
   return false;
@@ -10,24 +10,26 @@
 
 #include "InputStreamPVRBase.h"
 
-class CInputStreamPVRRecording : public CInputStreamPVRBase
+class CInputStreamPVRRecording : public CInputStreamPVRImpl<CInputStreamPVRRecording>
 {
 public:
-  using CInputStreamPVRBase::CInputStreamPVRBase;
+  using CInputStreamPVRImpl::CInputStreamPVRImpl;
   ~CInputStreamPVRRecording() override;
 
 protected:
-  bool OpenPVRStream() override;
-  void ClosePVRStream() override;
-  int ReadPVRStream(uint8_t* buf, int buf_size) override;
-  int64_t SeekPVRStream(int64_t offset, int whence) override;
-  int64_t GetPVRStreamLength() override;
-  ENextStream NextPVRStream() override;
-  bool CanPausePVRStream() override;
-  bool CanSeekPVRStream() override;
-  bool IsRealtimePVRStream() override;
-  void PausePVRStream(bool paused) override;
-  bool GetPVRStreamTimes(Times& times) override;
+  friend class CInputStreamPVRImpl<CInputStreamPVRRecording>;
+
+  bool OpenPVRStream();
+  void ClosePVRStream();
+  int ReadPVRStream(uint8_t* buf, int buf_size);
+  int64_t SeekPVRStream(int64_t offset, int whence);
+  int64_t GetPVRStreamLength();
+  ENextStream NextPVRStream();
+  bool CanPausePVRStream();
+  bool CanSeekPVRStream();
+  bool IsRealtimePVRStream();
+  void PausePVRStream(bool paused);
+  bool GetPVRStreamTimes(Times& times);
 
 private:
   int64_t m_streamId{-1};
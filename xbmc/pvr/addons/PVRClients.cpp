@@ -111,6 +111,7 @@ void CPVRClients::DestroyClients()
     client->Destroy();
   }
   m_clientMap.clear();
+  m_anyClientSupportingRecordingsSize = false;
 }
 
 CPVRClients::UpdateClientAction CPVRClients::GetUpdateClientAction(
@@ -282,6 +283,8 @@ void CPVRClients::UpdateClients(const std::string& changedAddonId /* = "" */)
 
     CServiceBroker::GetPVRManager().Start();
   }
+
+  UpdateRecordingsSizeSupport();
 }
 
 bool CPVRClients::RequestRestart(const std::string& addonId,
@@ -320,6 +323,8 @@ bool CPVRClients::StopClient(int clientId, bool restart)
 
       client->Destroy();
     }
+    lock.unlock();
+    UpdateRecordingsSizeSupport();
     return true;
   }
 
@@ -770,15 +775,21 @@ std::vector<std::shared_ptr<CPVRClient>> CPVRClients::GetClientsSupportingChanne
 }
 
 bool CPVRClients::AnyClientSupportingRecordingsSize() const
+{
+  return m_anyClientSupportingRecordingsSize;
+}
+
+void CPVRClients::UpdateRecordingsSizeSupport() const
 {
   std::unique_lock lock(m_critSection);
-  return std::ranges::any_of(m_clientMap,
-                             [](const auto& entry)
-                             {
-                               const auto& client = entry.second;
-                               return client->ReadyToUse() && !client->IgnoreClient() &&
-                                      client->GetClientCapabilities().SupportsRecordingsSize();
-                             });
+  m_anyClientSupportingRecordingsSize =
+      std::ranges::any_of(m_clientMap,
+                          [](const auto& entry)
+                          {
+                            const auto& client = entry.second;
+                            return client->ReadyToUse() && !client->IgnoreClient() &&
+                                   client->GetClientCapabilities().SupportsRecordingsSize();
+                          });
 }
 
 bool CPVRClients::AnyClientSupportingEPG() const
@@ -867,6 +878,10 @@ void CPVRClients::ConnectionStateChange(const CPVRClient* client,
   if (!client)
     return;
 
+  // the state change may have toggled the client's "ignore until connected"
+  // flag, which the cached recordings size support flag depends on
+  UpdateRecordingsSizeSupport();
+
   int iMsg = -1;
   EventLevel eLevel = EventLevel::Error;
   bool bNotify = true;
@@ -13,6 +13,7 @@
 #include "powermanagement/PowerState.h"
 #include "threads/CriticalSection.h"
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <string>
@@ -480,7 +481,17 @@ private:
                               F function,
                               std::vector<int>& failedClients) const;
 
+  /*!
+   * @brief Recompute the cached recordings size support flag. Must be called
+   * whenever clients are created, recreated or destroyed, or a client's
+   * connection state changes (clients are ignored until connected).
+   */
+  void UpdateRecordingsSizeSupport() const;
+
   mutable CCriticalSection m_critSection;
   CPVRClientMap m_clientMap;
+  // cached on client add/remove and connection state changes; saves a
+  // lock + capability scan per query
+  mutable std::atomic<bool> m_anyClientSupportingRecordingsSize{false};
 };
 } // namespace PVR
@@ -18,30 +18,73 @@
 #include "pvr/recordings/PVRRecordingsPath.h"
 #include "pvr/timers/PVRTimersPath.h"
 #include "settings/AdvancedSettings.h"
-#include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "view/ViewStateSettings.h"
 
+#include <array>
+
 using namespace PVR;
 
+namespace
+{
+using SortMethodDescriptor = CGUIViewState::SortMethodDescriptor;
+
+// label mask quadruples are: Filename, Filename right | Foldername, Foldername right
+constexpr std::array<SortMethodDescriptor, 6> ChannelsSortMethods{{
+    {SortBy::CHANNEL_NUMBER, 549, "%L", "", "%L", ""}, // "Number"
+    {SortBy::CHANNEL, 551, "%L", "", "%L", ""}, // "Name"
+    {SortBy::LAST_PLAYED, 568, "%L", "%p", "%L", "%p"}, // "Last played"
+    {SortBy::DATE_ADDED, 570, "%L", "%a", "%L", "%a", SortAttributeNone,
+     SortOrder::DESCENDING}, // "Date added"
+    {SortBy::CLIENT_CHANNEL_ORDER, 19315, "%L", "", "%L", ""}, // "Backend number"
+    {SortBy::PROVIDER, 19348, "%L", "", "%L", ""}, // "Provider"
+}};
+
+constexpr std::array<SortMethodDescriptor, 4> RecordingsSortMethods{{
+    {SortBy::LABEL, 551, "%L", "%d", "%L", "", SortAttributeNone, SortOrder::NONE,
+     true}, // "Name"
+    {SortBy::DATE, 552, "%L", "%d", "%L", "%d"}, // "Date"
+    {SortBy::TIME, 180, "%L", "%D", "%L", ""}, // "Duration"
+    {SortBy::FILE, 561, "%L", "%d", "%L", ""}, // "File"
+}};
+
+constexpr std::array<SortMethodDescriptor, 2> RecordingsExtraSortMethods{{
+    {SortBy::EPISODE_NUMBER, 20359, "%L", "%d", "%L", ""}, // "Episode"
+    {SortBy::PROVIDER, 19348, "%L", "", "%L", ""}, // "Provider"
+}};
+
+constexpr std::array<SortMethodDescriptor, 6> GuideSortMethods{{
+    {SortBy::CHANNEL_NUMBER, 549, "%L", "", "%L", ""}, // "Number"
+    {SortBy::CHANNEL, 551, "%L", "", "%L", ""}, // "Name"
+    {SortBy::LAST_PLAYED, 568, "%L", "%p", "%L", "%p", SortAttributeIgnoreLabel}, // "Last played"
+    {SortBy::DATE_ADDED, 570, "%L", "%a", "%L", "%a", SortAttributeNone,
+     SortOrder::DESCENDING}, // "Date added"
+    {SortBy::CLIENT_CHANNEL_ORDER, 19315, "%L", "", "%L", ""}, // "Backend number"
+    {SortBy::PROVIDER, 19348, "%L", "", "%L", ""}, // "Provider"
+}};
+
+constexpr std::array<SortMethodDescriptor, 2> TimersSortMethods{{
+    {SortBy::LABEL, 551, "%L", "", "%L", "", SortAttributeIgnoreFolders, SortOrder::NONE,
+     true}, // "Name"
+    {SortBy::DATE, 552, "%L", "%d", "%L", "%d", SortAttributeIgnoreFolders, SortOrder::NONE,
+     true}, // "Date"
+}};
+
+constexpr std::array<SortMethodDescriptor, 2> SearchSortMethods{{
+    {SortBy::LABEL, 551, "%L", "", "%L", ""}, // "Name"
+    {SortBy::DATE, 552, "%L", "%d", "%L", "%d"}, // "Date"
+}};
+
+constexpr std::array<SortMethodDescriptor, 1> ProvidersSortMethods{{
+    {SortBy::LABEL, 551, "%L", "", "%L", ""}, // "Name"
+}};
+} // unnamed namespace
+
 CGUIViewStateWindowPVRChannels::CGUIViewStateWindowPVRChannels(const int windowId,
                                                                const CFileItemList& items)
   : CGUIViewStatePVR(windowId, items)
 {
-  AddSortMethod(SortBy::CHANNEL_NUMBER, 549, // "Number"
-                LABEL_MASKS("%L", "", "%L", "")); // Filename, empty | Foldername, empty
-  AddSortMethod(SortBy::CHANNEL, 551, // "Name"
-                LABEL_MASKS("%L", "", "%L", "")); // Filename, empty | Foldername, empty
-  AddSortMethod(
-      SortBy::LAST_PLAYED, 568, // "Last played"
-      LABEL_MASKS("%L", "%p", "%L", "%p")); // Filename, LastPlayed | Foldername, LastPlayed
-  AddSortMethod(SortBy::DATE_ADDED, 570, // "Date added"
-                LABEL_MASKS("%L", "%a", "%L", "%a"), // Filename, DateAdded | Foldername, DateAdded
-                SortAttributeNone, SortOrder::DESCENDING);
-  AddSortMethod(SortBy::CLIENT_CHANNEL_ORDER, 19315, // "Backend number"
-                LABEL_MASKS("%L", "", "%L", "")); // Filename, empty | Foldername, empty
-  AddSortMethod(SortBy::PROVIDER, 19348, // "Provider"
-                LABEL_MASKS("%L", "", "%L", "")); // Filename, empty | Foldername, empty
+  AddSortMethods(ChannelsSortMethods);
 
   // Default sorting
   SetSortMethod(SortBy::CHANNEL_NUMBER);
@@ -59,18 +102,7 @@ CGUIViewStateWindowPVRRecordings::CGUIViewStateWindowPVRRecordings(const int win
                                                                    const CFileItemList& items)
   : CGUIViewStatePVR(windowId, items)
 {
-  AddSortMethod(SortBy::LABEL, 551, // "Name"
-                LABEL_MASKS("%L", "%d", "%L", ""), // Filename, DateTime | Foldername, empty
-                CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(
-                    CSettings::SETTING_FILELISTS_IGNORETHEWHENSORTING)
-                    ? SortAttributeIgnoreArticle
-                    : SortAttributeNone);
-  AddSortMethod(SortBy::DATE, 552, // "Date"
-                LABEL_MASKS("%L", "%d", "%L", "%d")); // Filename, DateTime | Foldername, DateTime
-  AddSortMethod(SortBy::TIME, 180, // "Duration"
-                LABEL_MASKS("%L", "%D", "%L", "")); // Filename, Duration | Foldername, empty
-  AddSortMethod(SortBy::FILE, 561, // "File"
-                LABEL_MASKS("%L", "%d", "%L", "")); // Filename, DateTime | Foldername, empty
+  AddSortMethods(RecordingsSortMethods);
 
   if (CServiceBroker::GetPVRManager().Clients()->AnyClientSupportingRecordingsSize())
   {
@@ -78,10 +110,7 @@ CGUIViewStateWindowPVRRecordings::CGUIViewStateWindowPVRRecordings(const int win
     AddSortMethod(SortBy::SIZE, 553, LABEL_MASKS("%L", "%I", "%L", "%I"));
   }
 
-  AddSortMethod(SortBy::EPISODE_NUMBER, 20359, // "Episode"
-                LABEL_MASKS("%L", "%d", "%L", "")); // Filename, DateTime | Foldername, empty
-  AddSortMethod(SortBy::PROVIDER, 19348, // "Provider"
-                LABEL_MASKS("%L", "", "%L", "")); // Filename, empty | Foldername, empty
+  AddSortMethods(RecordingsExtraSortMethods);
 
   SetSortMethod(
       CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_PVRDefaultSortOrder);
@@ -105,20 +134,7 @@ CGUIViewStateWindowPVRGuide::CGUIViewStateWindowPVRGuide(const int windowId,
                                                          const CFileItemList& items)
   : CGUIViewStatePVR(windowId, items)
 {
-  AddSortMethod(SortBy::CHANNEL_NUMBER, 549, // "Number"
-                LABEL_MASKS("%L", "", "%L", "")); // Filename, empty | Foldername, empty
-  AddSortMethod(SortBy::CHANNEL, 551, // "Name"
-                LABEL_MASKS("%L", "", "%L", "")); // Filename, empty | Foldername, empty
-  AddSortMethod(
-      SortBy::LAST_PLAYED, SortAttributeIgnoreLabel, 568, // "Last played"
-      LABEL_MASKS("%L", "%p", "%L", "%p")); // Filename, LastPlayed | Foldername, LastPlayed
-  AddSortMethod(SortBy::DATE_ADDED, 570, // "Date added"
-                LABEL_MASKS("%L", "%a", "%L", "%a"), // Filename, DateAdded | Foldername, DateAdded
-                SortAttributeNone, SortOrder::DESCENDING);
-  AddSortMethod(SortBy::CLIENT_CHANNEL_ORDER, 19315, // "Backend number"
-                LABEL_MASKS("%L", "", "%L", "")); // Filename, empty | Foldername, empty
-  AddSortMethod(SortBy::PROVIDER, 19348, // "Provider"
-                LABEL_MASKS("%L", "", "%L", "")); // Filename, empty | Foldername, empty
+  AddSortMethods(GuideSortMethods);
 
   // Default sorting
   SetSortMethod(SortBy::CHANNEL_NUMBER);
@@ -135,15 +151,7 @@ CGUIViewStateWindowPVRTimers::CGUIViewStateWindowPVRTimers(const int windowId,
                                                            const CFileItemList& items)
   : CGUIViewStatePVR(windowId, items)
 {
-  int sortAttributes(CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(
-                         CSettings::SETTING_FILELISTS_IGNORETHEWHENSORTING)
-                         ? SortAttributeIgnoreArticle
-                         : SortAttributeNone);
-  sortAttributes |= SortAttributeIgnoreFolders;
-  AddSortMethod(SortBy::LABEL, static_cast<SortAttribute>(sortAttributes), 551, // "Name"
-                LABEL_MASKS("%L", "", "%L", "")); // Filename, empty | Foldername, empty
-  AddSortMethod(SortBy::DATE, static_cast<SortAttribute>(sortAttributes), 552, // "Date"
-                LABEL_MASKS("%L", "%d", "%L", "%d")); // Filename, DateTime | Foldername, DateTime
+  AddSortMethods(TimersSortMethods);
 
   // Default sorting
   SetSortMethod(SortBy::DATE);
@@ -165,10 +173,7 @@ CGUIViewStateWindowPVRSearch::CGUIViewStateWindowPVRSearch(const int windowId,
                                                            const CFileItemList& items)
   : CGUIViewStatePVR(windowId, items)
 {
-  AddSortMethod(SortBy::LABEL, 551, // "Name"
-                LABEL_MASKS("%L", "", "%L", "")); // Filename, empty | Foldername, empty
-  AddSortMethod(SortBy::DATE, 552, // "Date"
-                LABEL_MASKS("%L", "%d", "%L", "%d")); // Filename, DateTime | Foldername, DateTime
+  AddSortMethods(SearchSortMethods);
 
   // Default sorting
   if (CPVREpgSearchPath(m_items.GetPath()).IsSavedSearchesRoot())
@@ -195,8 +200,7 @@ CGUIViewStateWindowPVRProviders::CGUIViewStateWindowPVRProviders(const int windo
                                                                  const CFileItemList& items)
   : CGUIViewStatePVR(windowId, items)
 {
-  AddSortMethod(SortBy::LABEL, 551, // "Name"
-                LABEL_MASKS("%L", "", "%L", "")); // Filename, empty | Foldername, empty
+  AddSortMethods(ProvidersSortMethods);
 
   if (CPVRProvidersPath(m_items.GetPath()).IsProvidersRoot())
   {
@@ -44,6 +44,8 @@
 #include "video/VideoUtils.h"
 #include "view/ViewState.h"
 
+#include <optional>
+
 #define PROPERTY_SORT_ORDER         "sort.order"
 #define PROPERTY_SORT_ASCENDING     "sort.ascending"
 
@@ -347,6 +349,30 @@ void CGUIViewState::AddSortMethod(const SortDescription& sortDescription,
   AddSortMethod(sortDescription.sortBy, sortDescription.sortAttributes, buttonLabel, labelMasks, sortDescription.sortOrder);
 }
 
+void CGUIViewState::AddSortMethods(std::span<const SortMethodDescriptor> descriptors)
+{
+  m_sortMethods.reserve(m_sortMethods.size() + descriptors.size());
+
+  std::optional<bool> ignoreArticle;
+  for (const SortMethodDescriptor& desc : descriptors)
+  {
+    int attributes = desc.sortAttributes;
+    if (desc.honorIgnoreArticleSetting)
+    {
+      if (!ignoreArticle.has_value())
+        ignoreArticle = CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(
+            CSettings::SETTING_FILELISTS_IGNORETHEWHENSORTING);
+      if (*ignoreArticle)
+        attributes |= SortAttributeIgnoreArticle;
+    }
+
+    AddSortMethod(desc.sortBy, static_cast<SortAttribute>(attributes), desc.buttonLabel,
+                  LABEL_MASKS(std::string(desc.labelFile), std::string(desc.label2File),
+                              std::string(desc.labelFolder), std::string(desc.label2Folder)),
+                  desc.sortOrder);
+  }
+}
+
 void CGUIViewState::SetCurrentSortMethod(int method)
 {
   if (method < static_cast<int>(SortBy::NONE) || method > static_cast<int>(SortBy::LAST_USED))
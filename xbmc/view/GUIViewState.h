@@ -12,6 +12,8 @@
 #include "utils/LabelFormatter.h"
 #include "utils/SortUtils.h"
 
+#include <span>
+#include <string_view>
 #include <vector>
 
 class CViewState; // forward
@@ -25,6 +27,24 @@ enum class Id;
 class CGUIViewState
 {
 public:
+  /*! \brief Static description of a sort method, for bulk registration via
+   AddSortMethods(). Can be stored in a constexpr table, avoiding per-view
+   construction of the label mask strings.
+   */
+  struct SortMethodDescriptor
+  {
+    SortBy sortBy{SortBy::NONE};
+    int buttonLabel{0};
+    std::string_view labelFile;
+    std::string_view label2File;
+    std::string_view labelFolder;
+    std::string_view label2Folder;
+    SortAttribute sortAttributes{SortAttributeNone};
+    SortOrder sortOrder{SortOrder::NONE};
+    //! add SortAttributeIgnoreArticle when the "ignore 'the' when sorting" setting is enabled
+    bool honorIgnoreArticleSetting{false};
+  };
+
   virtual ~CGUIViewState();
   static CGUIViewState* GetViewState(int windowId, const CFileItemList& items);
 
@@ -89,6 +109,12 @@ protected:
   void AddSortMethod(const SortDescription& sortDescription,
                      int buttonLabel,
                      const LABEL_MASKS& labelMasks);
+  /*! \brief Add a batch of sort methods from a static descriptor table.
+   Looks the "ignore 'the' when sorting" setting up at most once for the
+   whole batch.
+   \param descriptors the sort method descriptions to add.
+   */
+  void AddSortMethods(std::span<const SortMethodDescriptor> descriptors);
   void SetSortMethod(SortBy sortBy, SortOrder sortOrder = SortOrder::NONE);
   void SetSortMethod(const SortDescription& sortDescription);
   void SetSortOrder(SortOrder sortOrder);